@@ -34,6 +34,9 @@
 /* Sort file by depth: files with lower depth first. */
 #define SORT_BY_DEPTH false
 
+/* Show files as a tree with collapsible directories. */
+#define TREE_VIEW false
+
 /* Print the file path instead of opening the file. */
 #define STDOUT_MODE false
 
@@ -63,6 +66,9 @@
 #define SHOW_HIDDEN_SYMBOL "[+]"
 #define PATH_SEP " / "
 
+/* The indentation per depth level in the tree view. */
+#define TREE_INDENT "    "
+
 /* The name to display for the parent directory. */
 #define UP_TEXT ".."
 
@@ -83,6 +89,8 @@
 #define OPEN_MULTI_KEY KB_CUSTOM_1
 /* Key for toggling hidden files. */
 #define TOGGLE_HIDDEN_KEY KB_CUSTOM_2
+/* Key for expanding / collapsing directories in the tree view. */
+#define TOGGLE_EXPAND_KEY KB_CUSTOM_3
 
 /* Separators for open-custom commands. */
 #define OPEN_CUSTOM_CMD_NAME_SEP ";name:"
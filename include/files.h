@@ -1,8 +1,6 @@
 #ifndef FILE_BROWSER_FILES_H
 #define FILE_BROWSER_FILES_H
 
-#include <ftw.h>
-
 #include "types.h"
 
 /**
@@ -19,6 +17,33 @@ void load_files ( FileBrowserFileData *fd );
  */
 void load_files_from_stdin ( FileBrowserFileData *fd );
 
+/**
+ * Reloads the file list from the source it was listed from.
+ * Directories that were expanded in the tree view are expanded again.
+ * Does nothing if the source can not be listed again (e.g. stdin).
+ */
+void reload_files ( FileBrowserFileData *fd );
+
+/**
+ * Frees the current file list and loads the file list from the given source.
+ * Files added by the source's open function (e.g. the parent dir) are not sorted.
+ */
+void load_files_from_source ( const FBListingSource *source, FileBrowserFileData *fd );
+
+/**
+ * Appends an uninitialized file to the file list, expanding the list if necessary.
+ * The caller must set all fields of the returned file.
+ * The pointer is only valid until the next file is added.
+ */
+FBFile *new_file ( FileBrowserFileData *fd );
+
+/**
+ * Expands or collapses the directory at the given index in the tree view.
+ * Expanding lists only that directory's children from the file list's source and inserts them after it.
+ * Collapsing removes all files below the directory with a greater depth.
+ */
+void toggle_dir_expanded ( unsigned int index, FileBrowserFileData *fd );
+
 /**
  * Simplifies the given path (e.g. removes "..") and changes directory to it.
  */
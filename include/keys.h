@@ -29,6 +29,7 @@ void set_key_bindings (
         char *open_custom_key_str,
         char* open_multi_key_str,
         char* toggle_hidden_key_str,
+        char* toggle_expand_key_str,
         FileBrowserKeyData *kd );
 
 #endif
@@ -26,12 +26,17 @@ typedef struct {
     enum FBFileType type;
     /* Depth of the file when listing recursively. */
     unsigned int depth;
+    /* Whether the children of the directory are listed below it in the tree view. */
+    bool expanded;
 
     /* Rofi icon fetcher request IDs for possible icons. */
     uint32_t *icon_fetcher_requests;
     unsigned int num_icon_fetcher_requests;
 } FBFile;
 
+/* A source of files for the file list, see struct FBListingSource. */
+typedef struct FBListingSource FBListingSource;
+
 typedef struct {
     /* Absolute path of the current directory. */
     char *current_dir;
@@ -41,6 +46,8 @@ typedef struct {
     unsigned int num_files;
     /* Size of the files array. */
     unsigned int size_files;
+    /* The source the displayed files were listed from, or NULL. */
+    const FBListingSource *source;
     /* Glob patterns to exclude dirs / files, not NULL-terminated. */
     GPatternSpec **exclude_patterns;
     /* Number of exclude glob patters. */
@@ -59,12 +66,32 @@ typedef struct {
     bool sort_by_type;
     /* Show files with lower depth first. */
     bool sort_by_depth;
+    /* Show the files as a tree with collapsible directories instead of listing them recursively. */
+    bool tree_view;
     /* Hide the parent directory (..). */
     bool hide_parent;
     /* Text for the parent directory (..). */
     char *up_text;
 } FileBrowserFileData;
 
+/**
+ * A source that lists files into the file list, e.g. the current directory or stdin.
+ * Sources write their files directly into the file list with new_file ( fd ).
+ */
+struct FBListingSource {
+    /* Adds files that are not sorted (e.g. the parent dir). May be NULL. */
+    void ( *open ) ( FileBrowserFileData *fd );
+    /* Adds the files of the source to the file list. */
+    void ( *list ) ( FileBrowserFileData *fd );
+    /* Adds the children of the directory dir with the given depth to the file list, for the tree view.
+       May be NULL if the source can not expand directories. */
+    void ( *expand ) ( const char *dir, unsigned int depth, FileBrowserFileData *fd );
+    /* Sort the files according to the sort options. Otherwise, the order of the source is kept. */
+    bool sort;
+    /* The files can be listed again, e.g. after toggling hidden files. Stdin can only be read once. */
+    bool reloadable;
+};
+
 // ================================================================================================================= //
 
 typedef struct {
@@ -99,6 +126,8 @@ typedef struct {
     FBKey open_multi_key;
     /* Key for toggling hidden files. */
     FBKey toggle_hidden_key;
+    /* Key for expanding / collapsing directories in the tree view. */
+    FBKey toggle_expand_key;
 } FileBrowserKeyData;
 
 // ================================================================================================================= //
@@ -64,7 +64,7 @@ void set_user_cmds ( char **cmd_strs, FileBrowserModePrivateData *pd )
 
 void search_path_for_cmds ( FileBrowserModePrivateData *pd )
 {
-    char *path = g_strdup ( g_getenv ( "PATH" ) );
+    const char *path = g_getenv ( "PATH" );
     if ( path == NULL ) {
         print_err ( "Could not get $PATH environment variable to search for executables.\n" );
         return;
@@ -72,9 +72,15 @@ void search_path_for_cmds ( FileBrowserModePrivateData *pd )
 
     GHashTable *table = g_hash_table_new_full ( g_str_hash, g_str_equal, g_free, NULL );
 
-    char* dirname = strtok ( path, G_SEARCHPATH_SEPARATOR_S );
+    /* Split the path instead of modifying a copy of it with strtok. */
+    char **dirnames = g_strsplit ( path, G_SEARCHPATH_SEPARATOR_S, -1 );
+
+    for ( int i = 0; dirnames[i] != NULL; i++ ) {
+        char *dirname = dirnames[i];
+        if ( dirname[0] == '\0' ) {
+            continue;
+        }
 
-    while ( dirname != NULL ) {
         GDir *dir = g_dir_open ( dirname, 0, NULL );
 
         if ( dir == NULL ) {
@@ -92,11 +98,9 @@ void search_path_for_cmds ( FileBrowserModePrivateData *pd )
 
             g_dir_close ( dir );
         }
-
-        dirname = strtok ( NULL, G_SEARCHPATH_SEPARATOR_S );
     }
 
-    g_free ( path );
+    g_strfreev ( dirnames );
 
     FBCmd *cmds = malloc ( g_hash_table_size ( table ) * sizeof ( FBCmd ) );
     int num_cmds = 0;
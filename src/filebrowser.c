@@ -208,7 +208,12 @@ static ModeMode file_browser_result ( Mode *sw,  int mretv, char **input, unsign
     /* Toggle hidden files with toggle_hidden_key. */
     } else if ( key == kd->toggle_hidden_key ) {
         fd->show_hidden = ! fd->show_hidden;
-        load_files ( fd );
+        reload_files ( fd );
+        retv = RELOAD_DIALOG;
+
+    /* Expand or collapse directories in the tree view with toggle_expand_key. */
+    } else if ( key == kd->toggle_expand_key && fd->tree_view && selected_line != -1 ) {
+        toggle_dir_expanded ( selected_line, fd );
         retv = RELOAD_DIALOG;
 
     /* Default actions */
@@ -259,6 +264,19 @@ static char *file_browser_get_display_value ( const Mode *sw, unsigned int selec
     } else {
         int index = pd->open_custom ? pd->open_custom_index : selected_line;
         FBFile *fbfile = &fd->files[index];
+
+        /* Indent files in the tree view according to their depth. */
+        if ( fd->tree_view && ! pd->open_custom && fbfile->type != UP && fbfile->depth > 1 ) {
+            GString *indented_name = g_string_new ( NULL );
+            for ( unsigned int i = 1; i < fbfile->depth; i++ ) {
+                g_string_append ( indented_name, TREE_INDENT );
+            }
+            g_string_append ( indented_name, fbfile->name );
+            char *utf8_name = rofi_force_utf8 ( indented_name->str, indented_name->len );
+            g_string_free ( indented_name, true );
+            return utf8_name;
+        }
+
         return rofi_force_utf8 ( fbfile->name, strlen ( fbfile->name ) );
     }
 }
@@ -1,5 +1,10 @@
 #include <stdbool.h>
 #include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include <gmodule.h>
 #include <glib/gstdio.h>
 
@@ -7,16 +12,35 @@
 #include "util.h"
 #include "files.h"
 
-#ifdef HAVE_FTW_ACTIONRETVAL /* glibc */
-#define extended_nftw nftw
-#else
-#include "posix-compat/extended_nftw.h"
-#endif
+/**
+ * An entry of a directory that is being scanned.
+ */
+typedef struct {
+    /* Name of the entry. */
+    char *name;
+    /* Inode number and type reported by readdir. */
+    ino_t ino;
+    unsigned char d_type;
+    /* Type of the file, determined by resolve_entry. */
+    FBFileType type;
+    /* Scan the entry's contents if the depth allows it. */
+    bool descend;
+    /* Do not list the entry, e.g. because the directory has already been scanned. */
+    bool skip;
+} FBDirEntry;
 
 /**
- * Save file browser data globally so nftw's callback can access it.
+ * Options and state of a directory scan.
  */
-static FileBrowserFileData* global_fd;
+typedef struct {
+    FileBrowserFileData *fd;
+    /* Depth of the scanned directory, relative to the current directory. */
+    unsigned int base_depth;
+    /* Level up to which subdirectories are scanned. 0 means no limit. */
+    int max_level;
+    /* Device and inode numbers of the scanned directories when following symlinks, or NULL. */
+    GHashTable *visited_dirs;
+} FBScan;
 
 /**
  * Frees the current files and initializes the file list with size 1.
@@ -24,19 +48,75 @@ static FileBrowserFileData* global_fd;
 static void free_files ( FileBrowserFileData *fd );
 
 /**
- * Inserts a file into the file list of FileBrowserFileData, expanding the list if necessary.
+ * Frees the data of a single file.
  */
-static void insert_file ( FBFile *fbfile, FileBrowserFileData *fd );
+static void free_file ( FBFile *fbfile );
 
 /**
- * Matches a base name to the specified exclude glob patterns.
+ * Loads the file list from the given source and expands the directories that were expanded before again.
  */
-static bool match_glob_patterns(const char *basename, FileBrowserFileData *fd);
+static void load_files_keep_expanded ( const FBListingSource *source, FileBrowserFileData *fd );
+
+/**
+ * Listing source functions for the current directory.
+ */
+static void dir_source_open ( FileBrowserFileData *fd );
+static void dir_source_list ( FileBrowserFileData *fd );
+static void dir_source_expand ( const char *dir, unsigned int depth, FileBrowserFileData *fd );
+
+/**
+ * Listing source function for paths from stdin.
+ */
+static void stdin_source_list ( FileBrowserFileData *fd );
+
+/**
+ * Scans the given directory up to max_level levels (0 means no limit) and appends the found files to the file list.
+ * base_depth is the depth of the directory relative to the current directory.
+ */
+static void scan_dir ( const char *dir, unsigned int base_depth, int max_level, FileBrowserFileData *fd );
+
+/**
+ * Lists the entries of a single directory and scans its subdirectories recursively.
+ * rel_dir is the path of the directory relative to the scanned directory, or NULL for the scanned directory itself.
+ * level is the level of the entries, starting at 1.
+ */
+static void scan_dir_entries ( const char *dir, const char *rel_dir, int level, FBScan *scan );
+
+/**
+ * Determines the type of a directory entry. Only calls stat if the type reported by readdir is not sufficient.
+ */
+static void resolve_entry ( int dfd, FBDirEntry *entry, FBScan *scan );
+
+/**
+ * Marks a directory as scanned. Returns false if it has already been scanned.
+ */
+static bool visit_dir ( const struct stat *sb, FBScan *scan );
+
+/**
+ * Compares directory entries by inode number.
+ */
+static gint compare_dir_entries ( gconstpointer a, gconstpointer b );
+
+/**
+ * Sorts the given files according to the sort options.
+ */
+static void sort_files ( FBFile *files, unsigned int num_files, FileBrowserFileData *fd );
 
 /**
- * Function used by nftw to add files to the list recursively.
+ * Lists the children of the directory at the given index with the source's expand function and inserts them after it.
+ * Does nothing if the source can not expand directories.
  */
-static inline int add_file ( const char *fpath, G_GNUC_UNUSED const struct stat *sb, int typeflag, struct FTW *ftwbuf );
+static void expand_dir ( unsigned int index, FileBrowserFileData *fd );
+
+/**
+ * Removes the files listed below the directory at the given index.
+ */
+static void collapse_dir ( unsigned int index, FileBrowserFileData *fd );
+
+/**
+ * Matches a base name to the specified exclude glob patterns.
+ */
+static bool match_glob_patterns(const char *basename, FileBrowserFileData *fd);
 
 /**
  * Compares files alphabetically.
@@ -67,13 +147,35 @@ static gint compare_files_depth_type ( gconstpointer a, gconstpointer b, gpointe
  * Files of the same type are sorted alphabetically.
  */
 
+/**
+ * Lists the files in the current directory.
+ */
+static const FBListingSource dir_source = {
+    .open       = dir_source_open,
+    .list       = dir_source_list,
+    .expand     = dir_source_expand,
+    .sort       = true,
+    .reloadable = true,
+};
+
+/**
+ * Lists the paths read from stdin in the order they are given.
+ */
+static const FBListingSource stdin_source = {
+    .open       = NULL,
+    .list       = stdin_source_list,
+    .expand     = NULL,
+    .sort       = false,
+    .reloadable = false,
+};
+
 // ================================================================================================================= //
 
 static void free_files ( FileBrowserFileData *fd )
 {
     FBFile *files = fd->files;
     for ( unsigned int i = 0; i < fd->num_files; i++ ) {
-        g_free ( files[i].path );
+        free_file ( &files[i] );
     }
     fd->num_files = 0;
     fd->files = g_realloc ( fd->files, sizeof ( FBFile ) );
@@ -83,6 +185,7 @@ static void free_files ( FileBrowserFileData *fd )
 void destroy_files ( FileBrowserFileData *fd )
 {
     free_files( fd );
+    fd->source = NULL;
     g_free ( fd->current_dir );
     g_free ( fd->files );
     g_free ( fd->up_text );
@@ -96,208 +199,403 @@ void destroy_files ( FileBrowserFileData *fd )
     fd->num_exclude_patterns = 0;
 }
 
-static void insert_file ( FBFile *fbfile, FileBrowserFileData *fd ) {
+static void free_file ( FBFile *fbfile )
+{
+    g_free ( fbfile->path );
+    free ( fbfile->icon_fetcher_requests );
+}
+
+FBFile *new_file ( FileBrowserFileData *fd )
+{
     /* Increase the array size if needed. */
     if ( fd->size_files <= fd->num_files ) {
         fd->size_files *= 2;
         fd->files = g_realloc ( fd->files, ( fd->size_files ) * sizeof ( FBFile ) );
     }
-    fd->files[fd->num_files] = *fbfile;
     fd->num_files++;
+    return &fd->files[fd->num_files - 1];
 }
 
 void load_files ( FileBrowserFileData *fd )
+{
+    load_files_from_source ( &dir_source, fd );
+}
+
+void load_files_from_stdin ( FileBrowserFileData *fd )
+{
+    load_files_from_source ( &stdin_source, fd );
+}
+
+void reload_files ( FileBrowserFileData *fd )
+{
+    if ( fd->source == NULL || ! fd->source->reloadable ) {
+        return;
+    }
+
+    load_files_keep_expanded ( fd->source, fd );
+}
+
+static void load_files_keep_expanded ( const FBListingSource *source, FileBrowserFileData *fd )
+{
+    GHashTable *expanded_paths = g_hash_table_new_full ( g_str_hash, g_str_equal, g_free, NULL );
+    for ( unsigned int i = 0; i < fd->num_files; i++ ) {
+        if ( fd->files[i].expanded ) {
+            g_hash_table_add ( expanded_paths, g_strdup ( fd->files[i].path ) );
+        }
+    }
+
+    load_files_from_source ( source, fd );
+
+    /* Children are inserted directly after their parent, so nested directories are expanded by the same loop. */
+    for ( unsigned int i = 0; i < fd->num_files; i++ ) {
+        if ( fd->files[i].type == DIRECTORY && g_hash_table_contains ( expanded_paths, fd->files[i].path ) ) {
+            expand_dir ( i, fd );
+        }
+    }
+
+    g_hash_table_destroy ( expanded_paths );
+}
+
+void load_files_from_source ( const FBListingSource *source, FileBrowserFileData *fd )
 {
     free_files ( fd );
 
-    if ( ! fd->hide_parent ) {
-        /* Insert the parent dir. */
-        FBFile up;
-        up.type = UP;
-        up.name = fd->up_text;
-        up.path = g_build_filename ( fd->current_dir, "..", NULL );
-        up.depth = -1;
-        up.icon_fetcher_requests = NULL;
-        up.num_icon_fetcher_requests = 0;
-        insert_file(&up, fd);
+    fd->source = source;
+    if ( source->open != NULL ) {
+        source->open ( fd );
     }
 
-    /* Load the files. */
-    global_fd = fd;
+    /* Exclude the files added by open (e.g. the parent dir) from sorting. */
+    unsigned int start = fd->num_files;
+
+    source->list ( fd );
 
-    int nftw_flags = fd->follow_symlinks ? FTW_ACTIONRETVAL : ( FTW_ACTIONRETVAL | FTW_PHYS );
-    /* Workaround to make nftw work if the current directory is a symlink. */
-    char *path = g_build_filename ( fd->current_dir, ".", NULL );
-    extended_nftw ( path , add_file, 16, nftw_flags );
-    g_free ( path );
+    if ( source->sort ) {
+        sort_files ( &fd->files[start], fd->num_files - start, fd );
+    }
+}
 
-    /* Exclude the parent dir from sorting. */
-    FBFile *sort_files = fd->files;
-    int num_sort_files = fd->num_files;
+static void dir_source_open ( FileBrowserFileData *fd )
+{
     if ( ! fd->hide_parent ) {
-        sort_files++;
-        num_sort_files--;
+        /* Insert the parent dir. */
+        FBFile *up = new_file ( fd );
+        up->type = UP;
+        up->name = fd->up_text;
+        up->path = g_build_filename ( fd->current_dir, "..", NULL );
+        up->depth = -1;
+        up->expanded = false;
+        up->icon_fetcher_requests = NULL;
+        up->num_icon_fetcher_requests = 0;
     }
+}
 
-    /* Sort all but the parent dir. */
-    if ( fd->sort_by_type ) {
-        if ( fd->sort_by_depth ) {
-            g_qsort_with_data ( sort_files, num_sort_files, sizeof ( FBFile ), compare_files_depth_type, NULL );
+static void dir_source_list ( FileBrowserFileData *fd )
+{
+    /* Load the files. In the tree view, only the current directory is scanned. */
+    scan_dir ( fd->current_dir, 0, fd->tree_view ? 1 : fd->depth, fd );
+}
+
+static void dir_source_expand ( const char *dir, unsigned int depth, FileBrowserFileData *fd )
+{
+    /* Scan only the directory itself. */
+    scan_dir ( dir, depth, 1, fd );
+}
+
+static void stdin_source_list ( FileBrowserFileData *fd )
+{
+    size_t current_dir_len = strlen ( fd->current_dir );
+
+    char *buffer = NULL;
+    size_t len = 0;
+    ssize_t read;
+
+    while ( ( read = getline ( &buffer, &len, stdin ) ) != -1 ) {
+        /* Strip the newline. */
+        buffer[read - 1] = '\0';
+
+        FBFile *fbfile = new_file ( fd );
+        fbfile->type = UNKNOWN;
+        fbfile->depth = 1;
+        fbfile->expanded = false;
+        fbfile->icon_fetcher_requests = NULL;
+        fbfile->num_icon_fetcher_requests = 0;
+
+        /* If path is absolute. */
+        if ( g_path_is_absolute ( buffer ) ) {
+            fbfile->path = g_strdup ( buffer );
+            fbfile->name = fbfile->path;
         } else {
-            g_qsort_with_data ( sort_files, num_sort_files, sizeof ( FBFile ), compare_files_type, NULL );
+            fbfile->path = g_strconcat ( fd->current_dir, "/", buffer, NULL );
+            fbfile->name = &fbfile->path[current_dir_len + 1];
         }
+    }
+
+    g_free ( buffer );
+}
+
+void toggle_dir_expanded ( unsigned int index, FileBrowserFileData *fd )
+{
+    if ( index >= fd->num_files || fd->files[index].type != DIRECTORY ) {
+        return;
+    }
+
+    if ( fd->files[index].expanded ) {
+        collapse_dir ( index, fd );
     } else {
-        if ( fd->sort_by_depth ) {
-            g_qsort_with_data ( sort_files, num_sort_files, sizeof ( FBFile ), compare_files_depth, NULL );
-        } else {
-            g_qsort_with_data ( sort_files, num_sort_files, sizeof ( FBFile ), compare_files, NULL );
-        }
+        expand_dir ( index, fd );
     }
 }
 
-void change_dir ( char *path, FileBrowserFileData *pd )
+static void expand_dir ( unsigned int index, FileBrowserFileData *fd )
 {
-    char* new_dir = get_canonical_abs_path ( path, pd->current_dir );
-    g_free ( pd->current_dir );
-    pd->current_dir = new_dir;
-    g_chdir ( new_dir );
+    if ( fd->source == NULL || fd->source->expand == NULL ) {
+        return;
+    }
+
+    unsigned int old_num_files = fd->num_files;
+
+    /* The children are appended to the end of the list. */
+    fd->source->expand ( fd->files[index].path, fd->files[index].depth, fd );
+
+    fd->files[index].expanded = true;
+
+    unsigned int num_children = fd->num_files - old_num_files;
+    if ( num_children == 0 ) {
+        return;
+    }
+
+    if ( fd->source->sort ) {
+        sort_files ( &fd->files[old_num_files], num_children, fd );
+    }
+
+    /* Move the children directly after the directory. */
+    FBFile *children = g_malloc ( num_children * sizeof ( FBFile ) );
+    memcpy ( children, &fd->files[old_num_files], num_children * sizeof ( FBFile ) );
+    memmove ( &fd->files[index + 1 + num_children], &fd->files[index + 1],
+              ( old_num_files - index - 1 ) * sizeof ( FBFile ) );
+    memcpy ( &fd->files[index + 1], children, num_children * sizeof ( FBFile ) );
+    g_free ( children );
 }
 
-static bool match_glob_patterns ( const char *basename, FileBrowserFileData *fd )
+static void collapse_dir ( unsigned int index, FileBrowserFileData *fd )
 {
-    int len = strlen ( basename );
-    for ( int i = 0; i < fd->num_exclude_patterns; i++ ) {
-        if ( g_pattern_match ( fd->exclude_patterns[i], len, basename, NULL ) ) {
-            return false;
+    unsigned int depth = fd->files[index].depth;
+
+    /* Find the end of the subtree. */
+    unsigned int end = index + 1;
+    while ( end < fd->num_files && fd->files[end].depth > depth ) {
+        free_file ( &fd->files[end] );
+        end++;
+    }
+
+    memmove ( &fd->files[index + 1], &fd->files[end], ( fd->num_files - end ) * sizeof ( FBFile ) );
+    fd->num_files -= end - ( index + 1 );
+    fd->files[index].expanded = false;
+}
+
+static void scan_dir ( const char *dir, unsigned int base_depth, int max_level, FileBrowserFileData *fd )
+{
+    FBScan scan = {
+        .fd           = fd,
+        .base_depth   = base_depth,
+        .max_level    = max_level,
+        .visited_dirs = NULL
+    };
+
+    /* When following symlinks, every directory is only reported once. */
+    if ( fd->follow_symlinks ) {
+        scan.visited_dirs = g_hash_table_new_full ( g_str_hash, g_str_equal, g_free, NULL );
+        struct stat sb;
+        if ( stat ( dir, &sb ) == 0 ) {
+            visit_dir ( &sb, &scan );
         }
     }
-    return true;
+
+    scan_dir_entries ( dir, NULL, 1, &scan );
+
+    if ( scan.visited_dirs != NULL ) {
+        g_hash_table_destroy ( scan.visited_dirs );
+    }
 }
 
-static int add_file ( const char *fpath, G_GNUC_UNUSED const struct stat *sb, int typeflag, struct FTW *ftwbuf )
+static void scan_dir_entries ( const char *dir, const char *rel_dir, int level, FBScan *scan )
 {
-    FileBrowserFileData *fd = global_fd;
-
-    const char *basename = &fpath[ftwbuf->base];
-
-    /* Skip the current dir itself. */
-    if ( ftwbuf->level == 0 ) {
-        return FTW_CONTINUE;
-    /* Skip hidden files. */
-    } else if ( ! fd->show_hidden && basename[0] == '.' ) {
-        return FTW_SKIP_SUBTREE;
-    /* Skip excluded patterns. */
-    } else if ( ! match_glob_patterns ( basename, fd ) ) {
-        return FTW_SKIP_SUBTREE;
+    FileBrowserFileData *fd = scan->fd;
+
+    DIR *dirp = opendir ( dir );
+    if ( dirp == NULL ) {
+        return;
     }
 
-    FBFile fbfile;
+    GArray *entries = g_array_new ( false, false, sizeof ( FBDirEntry ) );
+
+    struct dirent *de;
+    while ( ( de = readdir ( dirp ) ) != NULL ) {
+        const char *name = de->d_name;
+
+        /* Skip "." and "..". */
+        if ( name[0] == '.' && ( name[1] == '\0' || ( name[1] == '.' && name[2] == '\0' ) ) ) {
+            continue;
+        /* Skip hidden files. */
+        } else if ( ! fd->show_hidden && name[0] == '.' ) {
+            continue;
+        /* Skip excluded patterns. */
+        } else if ( ! match_glob_patterns ( name, fd ) ) {
+            continue;
+        }
 
-    switch ( typeflag ) {
+        FBDirEntry entry = { .name = g_strdup ( name ), .ino = de->d_ino, .d_type = de->d_type };
+        g_array_append_val ( entries, entry );
+    }
 
-        /* Regular file. */
-        case FTW_F:
-        file:
-            if ( fd->only_dirs ) {
-                goto skip_file;
-            } else {
-                fbfile.type = RFILE;
+    /* Fetch the metadata of the entries in inode order instead of readdir order,
+       so that the inode table is read sequentially instead of seeking back and forth. */
+    g_array_sort ( entries, compare_dir_entries );
+    for ( unsigned int i = 0; i < entries->len; i++ ) {
+        resolve_entry ( dirfd ( dirp ), &g_array_index ( entries, FBDirEntry, i ), scan );
+    }
+
+    closedir ( dirp );
+
+    for ( unsigned int i = 0; i < entries->len; i++ ) {
+        FBDirEntry *entry = &g_array_index ( entries, FBDirEntry, i );
+
+        char *path = g_build_filename ( dir, entry->name, NULL );
+        char *rel_path = rel_dir == NULL ? g_strdup ( entry->name ) : g_build_filename ( rel_dir, entry->name, NULL );
+
+        bool list = ! entry->skip
+                 && ! ( fd->only_dirs && entry->type == RFILE )
+                 && ! ( fd->only_files && entry->type == DIRECTORY );
+
+        if ( list ) {
+            FBFile *fbfile = new_file ( fd );
+            fbfile->type = entry->type;
+            fbfile->path = path;
+            /* The display name is the path relative to the scanned directory. */
+            fbfile->name = &path[strlen ( path ) - strlen ( rel_path )];
+            fbfile->depth = scan->base_depth + level;
+            fbfile->expanded = false;
+            fbfile->icon_fetcher_requests = NULL;
+            fbfile->num_icon_fetcher_requests = 0;
+        }
+
+        if ( ! entry->skip && entry->descend && ( scan->max_level == 0 || level < scan->max_level ) ) {
+            scan_dir_entries ( path, rel_path, level + 1, scan );
+        }
+
+        if ( ! list ) {
+            g_free ( path );
+        }
+        g_free ( rel_path );
+        g_free ( entry->name );
+    }
+
+    g_array_free ( entries, true );
+}
+
+static void resolve_entry ( int dfd, FBDirEntry *entry, FBScan *scan )
+{
+    bool follow_symlinks = scan->fd->follow_symlinks;
+    unsigned char d_type = entry->d_type;
+    struct stat sb;
+
+    entry->type = UNKNOWN;
+    entry->descend = false;
+    entry->skip = false;
+
+    /* Stat if readdir did not report the type, or to follow symlinks and check for already scanned directories. */
+    if ( d_type == DT_UNKNOWN || ( follow_symlinks && ( d_type == DT_LNK || d_type == DT_DIR ) ) ) {
+        if ( fstatat ( dfd, entry->name, &sb, follow_symlinks ? 0 : AT_SYMLINK_NOFOLLOW ) != 0 ) {
+            /* Symbolic link pointing to nonexistent file. */
+            if ( follow_symlinks && errno == ENOENT ) {
+                entry->type = INACCESSIBLE;
             }
-            break;
+            return;
+        }
 
-        /* Regular directory. */
-        case FTW_D:
-        directory:
-            if ( fd->only_files ) {
-                goto skip_file;
-            } else {
-                fbfile.type = DIRECTORY;
+        if ( S_ISDIR ( sb.st_mode ) ) {
+            d_type = DT_DIR;
+            if ( follow_symlinks && ! visit_dir ( &sb, scan ) ) {
+                entry->skip = true;
+                return;
             }
-            break;
+        } else if ( S_ISLNK ( sb.st_mode ) ) {
+            d_type = DT_LNK;
+        } else {
+            d_type = DT_REG;
+        }
+    }
 
-        /* Inaccessible directory. */
-        case FTW_DNR:
-            fbfile.type = INACCESSIBLE;
-            break;
+    switch ( d_type ) {
 
-        /* Symbolic link. */
-        case FTW_SL:
-            if ( g_file_test ( fpath, G_FILE_TEST_IS_DIR ) ) {
-                goto directory;
+        /* Directory, inaccessible if it can not be read. */
+        case DT_DIR:
+            if ( faccessat ( dfd, entry->name, R_OK, 0 ) == 0 ) {
+                entry->type = DIRECTORY;
+                entry->descend = true;
             } else {
-                goto file;
+                entry->type = INACCESSIBLE;
             }
             break;
 
-        /* Symbolic link pointing to nonexistent file. */
-        case FTW_SLN:
-            fbfile.type = INACCESSIBLE;
+        /* Symbolic link that is not followed. Links to directories are shown as directories, but not scanned. */
+        case DT_LNK:
+            if ( fstatat ( dfd, entry->name, &sb, 0 ) == 0 && S_ISDIR ( sb.st_mode ) ) {
+                entry->type = DIRECTORY;
+            } else {
+                entry->type = RFILE;
+            }
             break;
 
         default:
-            fbfile.type = UNKNOWN;
+            entry->type = RFILE;
             break;
     }
+}
 
-    /* Determine the start position of the display name in the path. */
-    int pos = strlen ( fpath ) - 1;
-    int level = ftwbuf->level;
-    while ( level > 0 ) {
-        pos--;
-        if ( fpath[pos] == G_DIR_SEPARATOR ) {
-            level--;
-        }
-    }
-    pos++;
-
-    fbfile.path = g_strdup ( fpath );
-    fbfile.name = &fbfile.path[pos];
-    fbfile.depth = ftwbuf->level;
-    fbfile.icon_fetcher_requests = NULL;
-    fbfile.num_icon_fetcher_requests = 0;
-
-    insert_file ( &fbfile, fd );
-
-skip_file:
+static bool visit_dir ( const struct stat *sb, FBScan *scan )
+{
+    /* dev_t and ino_t can be wider than unsigned long, e.g. on 32 bit systems with 64 bit file offsets. */
+    char *key = g_strdup_printf ( "%" G_GUINT64_FORMAT ":%" G_GUINT64_FORMAT,
+                                  ( guint64 ) sb->st_dev, ( guint64 ) sb->st_ino );
+    return g_hash_table_add ( scan->visited_dirs, key );
+}
 
-    if ( ftwbuf->level >= global_fd->depth && fd->depth != 0 ) {
-        return FTW_SKIP_SUBTREE;
+static void sort_files ( FBFile *files, unsigned int num_files, FileBrowserFileData *fd )
+{
+    if ( fd->sort_by_type ) {
+        if ( fd->sort_by_depth ) {
+            g_qsort_with_data ( files, num_files, sizeof ( FBFile ), compare_files_depth_type, NULL );
+        } else {
+            g_qsort_with_data ( files, num_files, sizeof ( FBFile ), compare_files_type, NULL );
+        }
     } else {
-        return FTW_CONTINUE;
+        if ( fd->sort_by_depth ) {
+            g_qsort_with_data ( files, num_files, sizeof ( FBFile ), compare_files_depth, NULL );
+        } else {
+            g_qsort_with_data ( files, num_files, sizeof ( FBFile ), compare_files, NULL );
+        }
     }
 }
 
-void load_files_from_stdin ( FileBrowserFileData *fd ) {
-    free_files ( fd );
-    size_t current_dir_len = strlen ( fd->current_dir );
-
-    char *buffer = NULL;
-    size_t len = 0;
-    ssize_t read;
-
-    while ( ( read = getline ( &buffer, &len, stdin ) ) != -1 ) {
-        /* Strip the newline. */
-        buffer[read - 1] = '\0';
-
-        FBFile fbfile;
-        fbfile.type = UNKNOWN;
-        fbfile.depth = 1;
-        fbfile.icon_fetcher_requests = NULL;
-        fbfile.num_icon_fetcher_requests = 0;
+void change_dir ( char *path, FileBrowserFileData *pd )
+{
+    char* new_dir = get_canonical_abs_path ( path, pd->current_dir );
+    g_free ( pd->current_dir );
+    pd->current_dir = new_dir;
+    g_chdir ( new_dir );
+}
 
-        /* If path is absolute. */
-        if ( g_path_is_absolute ( buffer ) ) {
-            fbfile.path = g_strdup ( buffer );
-            fbfile.name = fbfile.path;
-        } else {
-            fbfile.path = g_strconcat ( fd->current_dir, "/", buffer, NULL );
-            fbfile.name = &fbfile.path[current_dir_len + 1];
+static bool match_glob_patterns ( const char *basename, FileBrowserFileData *fd )
+{
+    int len = strlen ( basename );
+    for ( int i = 0; i < fd->num_exclude_patterns; i++ ) {
+        if ( g_pattern_match ( fd->exclude_patterns[i], len, basename, NULL ) ) {
+            return false;
         }
-
-        insert_file ( &fbfile, fd );
     }
-
-    g_free ( buffer );
+    return true;
 }
 
 static gint compare_files ( gconstpointer a, gconstpointer b, G_GNUC_UNUSED gpointer data )
@@ -341,3 +639,14 @@ static gint compare_files_depth_type ( gconstpointer a, gconstpointer b, G_GNUC_
         return g_strcmp0 ( fa->name, fb->name );
     }
 }
+
+static gint compare_dir_entries ( gconstpointer a, gconstpointer b )
+{
+    const FBDirEntry *ea = a;
+    const FBDirEntry *eb = b;
+    if ( ea->ino != eb->ino ) {
+        return ea->ino < eb->ino ? -1 : 1;
+    } else {
+        return 0;
+    }
+}
@@ -60,23 +60,28 @@ void set_key_bindings (
         char *open_custom_key_str,
         char* open_multi_key_str,
         char* toggle_hidden_key_str,
+        char* toggle_expand_key_str,
         FileBrowserKeyData *kd )
 {
     kd->open_custom_key   = OPEN_CUSTOM_KEY;
     kd->open_multi_key    = OPEN_MULTI_KEY;
     kd->toggle_hidden_key = TOGGLE_HIDDEN_KEY;
+    kd->toggle_expand_key = TOGGLE_EXPAND_KEY;
 
     FBKey *keys[] = { &kd->open_custom_key,
                       &kd->open_multi_key,
-                      &kd->toggle_hidden_key };
+                      &kd->toggle_hidden_key,
+                      &kd->toggle_expand_key };
     char *names[] = { "open-custom",
                       "open-multi",
-                      "toggle-hidden" };
+                      "toggle-hidden",
+                      "toggle-expand" };
     char *params[] = { open_custom_key_str,
                        open_multi_key_str,
-                       toggle_hidden_key_str };
+                       toggle_hidden_key_str,
+                       toggle_expand_key_str };
 
-    for ( int i = 0; i < 3; i++ ) {
+    for ( unsigned int i = 0; i < G_N_ELEMENTS ( keys ); i++ ) {
         if ( params[i] != NULL ) {
             *keys[i] = get_key_for_name ( params[i] );
             if ( *keys[i] == KEY_UNSUPPORTED ) {
@@ -88,9 +93,9 @@ void set_key_bindings (
         }
     }
 
-    for ( int i = 0; i < 3; i++ ) {
+    for ( unsigned int i = 0; i < G_N_ELEMENTS ( keys ); i++ ) {
         if ( *keys[i] != KEY_NONE ) {
-            for ( int j = 0; j < 3; j++ ) {
+            for ( unsigned int j = 0; j < G_N_ELEMENTS ( keys ); j++ ) {
                 if ( i != j && *keys[i] == *keys[j] ) {
                     *keys[j] = KEY_NONE;
                     char *key_name = get_name_of_key ( *keys[i] );
@@ -103,6 +103,14 @@ bool set_options ( FileBrowserModePrivateData *pd )
     pd->open_parent_as_self  = fb_find_arg ( "-file-browser-open-parent-as-self" , pd ) ? true  : OPEN_PARENT_AS_SELF;
     pd->search_path_for_cmds = fb_find_arg ( "-file-browser-oc-search-path"      , pd ) ? true  : SEARCH_PATH_FOR_CMDS;
     pd->resume               = fb_find_arg ( "-file-browser-resume"              , pd ) ? true  : RESUME;
+    fd->tree_view            = fb_find_arg ( "-file-browser-tree"                , pd ) ? true  : TREE_VIEW;
+
+    /* Directories can not be expanded if they are not shown. */
+    if ( fd->tree_view && fd->only_files ) {
+        print_err ( "Option \"-file-browser-tree\" can not be used with \"-file-browser-only-files\". "
+                    "Disabling the tree view.\n" );
+        fd->tree_view = false;
+    }
 
     fd->up_text             = str_arg_or_default ( "-file-browser-up-text",            UP_TEXT,            pd );
     id->up_icon             = str_arg_or_default ( "-file-browser-up-icon",            UP_ICON,            pd );
@@ -161,10 +169,13 @@ bool set_options ( FileBrowserModePrivateData *pd )
     char *open_custom_key_str =   str_arg_or_default ( "-file-browser-open-custom-key",   NULL, pd );
     char *open_multi_key_str =    str_arg_or_default ( "-file-browser-open-multi-key",    NULL, pd );
     char *toggle_hidden_key_str = str_arg_or_default ( "-file-browser-toggle-hidden-key", NULL, pd );
-    set_key_bindings ( open_custom_key_str, open_multi_key_str, toggle_hidden_key_str, &pd->key_data );
+    char *toggle_expand_key_str = str_arg_or_default ( "-file-browser-toggle-expand-key", NULL, pd );
+    set_key_bindings ( open_custom_key_str, open_multi_key_str, toggle_hidden_key_str, toggle_expand_key_str,
+                       &pd->key_data );
     g_free ( open_custom_key_str );
     g_free ( open_multi_key_str );
     g_free ( toggle_hidden_key_str );
+    g_free ( toggle_expand_key_str );
 
     return true;
 }